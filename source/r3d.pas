@@ -80,6 +80,9 @@ implementation
   //
 {$ENDIF}
 
+uses
+  {$IFDEF UNIX}BaseUnix,{$ENDIF} Classes, Math;
+
 function R3D_MATERIAL_BASE: TR3D_Material; inline;
 begin
   Result := Default(TR3D_Material);
@@ -156,6 +159,1346 @@ begin
   Result.sunEnergy := 1.0;
 end;
 
+function R3D_DYNAMIC_RESOLUTION_BASE(maxWidth, maxHeight: Integer): TR3D_DynamicResolution;
+begin
+  Result := Default(TR3D_DynamicResolution);
+  Result.maxWidth := maxWidth;
+  Result.maxHeight := maxHeight;
+  Result.targetFrameTime := 1.0 / 60.0;
+  Result.minScale := 0.5;
+  Result.maxScale := 1.0;
+  Result.step := 0.1;
+  Result.hysteresis := 0.1;
+  Result.cooldown := 1.0;
+  Result.scale := 1.0;
+end;
+
+procedure R3D_UpdateDynamicResolution(var state: TR3D_DynamicResolution; frameTime: Single);
+var
+  newScale: Single;
+  width, height: Integer;
+begin
+  with state do
+  begin
+    if averageFrameTime <= 0.0 then averageFrameTime := frameTime
+    else averageFrameTime := averageFrameTime + (frameTime - averageFrameTime) * 0.1;
+
+    timer := timer + frameTime;
+    if timer < cooldown then Exit;
+
+    newScale := scale;
+    if averageFrameTime > targetFrameTime * (1.0 + hysteresis) then
+    begin
+      newScale := scale - step;
+      if newScale < minScale then newScale := minScale;
+    end
+    else if averageFrameTime < targetFrameTime * (1.0 - hysteresis) then
+    begin
+      newScale := scale + step;
+      if newScale > maxScale then newScale := maxScale;
+
+      // Стоимость растёт как квадрат масштаба: не повышаем разрешение,
+      // если после шага время кадра выйдет за верхнюю границу и масштаб сразу вернётся назад
+      if averageFrameTime * Sqr(newScale / scale) >= targetFrameTime * (1.0 + hysteresis) then
+        newScale := scale;
+    end;
+
+    if Abs(newScale - scale) < 0.001 then Exit;
+
+    scale := newScale;
+    averageFrameTime := 0.0;
+    timer := 0.0;
+
+    width := Round(maxWidth * scale);
+    height := Round(maxHeight * scale);
+    if width < 1 then width := 1;
+    if height < 1 then height := 1;
+
+    R3D_UpdateResolution(width, height);
+  end;
+end;
+
+const
+  R3D_QUALITY_SETTINGS: array[TR3D_QualityTier] of TR3D_QualitySettings = (
+    (ssaoSampleCount: 8;  ssilSampleCount: 2; ssilSliceCount: 2; ssrMaxRaySteps: 16; ssrBinarySearchSteps: 4;  bloomLevels: 0.3),
+    (ssaoSampleCount: 12; ssilSampleCount: 4; ssilSliceCount: 2; ssrMaxRaySteps: 32; ssrBinarySearchSteps: 6;  bloomLevels: 0.4),
+    (ssaoSampleCount: 16; ssilSampleCount: 4; ssilSliceCount: 4; ssrMaxRaySteps: 64; ssrBinarySearchSteps: 8;  bloomLevels: 0.5),
+    (ssaoSampleCount: 32; ssilSampleCount: 8; ssilSliceCount: 4; ssrMaxRaySteps: 96; ssrBinarySearchSteps: 12; bloomLevels: 0.6)
+  );
+
+function R3D_GetQualitySettings(tier: TR3D_QualityTier): TR3D_QualitySettings;
+begin
+  Result := R3D_QUALITY_SETTINGS[tier];
+end;
+
+procedure R3D_ApplyQualitySettings(const settings: TR3D_QualitySettings);
+var
+  Env: PR3D_Environment;
+begin
+  Env := R3D_GetEnvironment();
+  if not Assigned(Env) then Exit;
+
+  Env^.ssao.sampleCount := settings.ssaoSampleCount;
+  Env^.ssil.sampleCount := settings.ssilSampleCount;
+  Env^.ssil.sliceCount := settings.ssilSliceCount;
+  Env^.ssr.maxRaySteps := settings.ssrMaxRaySteps;
+  Env^.ssr.binarySearchSteps := settings.ssrBinarySearchSteps;
+  Env^.bloom.levels := settings.bloomLevels;
+end;
+
+procedure R3D_ApplyQualityTier(tier: TR3D_QualityTier);
+begin
+  R3D_ApplyQualitySettings(R3D_QUALITY_SETTINGS[tier]);
+end;
+
+function R3D_BenchmarkQualityTier(drawScene: R3D_QualityBenchmarkCallback; userData: Pointer;
+  frameBudget: Single; targetFPS: Integer; frameCount: Integer): TR3D_QualityTier;
+var
+  tier: TR3D_QualityTier;
+  i: Integer;
+  start, frameTime: Double;
+begin
+  Result := Low(TR3D_QualityTier);
+  if (not Assigned(drawScene)) or (frameCount < 1) then Exit;
+
+  // Ограничитель кадров растягивает каждый кадр до цели, отключаем его на время замера
+  SetTargetFPS(0);
+  try
+    for tier := High(TR3D_QualityTier) downto Low(TR3D_QualityTier) do
+    begin
+      R3D_ApplyQualityTier(tier);
+
+      // Кадр прогрева: шейдеры и буферы эффектов могут создаваться при первом использовании
+      BeginDrawing();
+      drawScene(userData);
+      EndDrawing();
+
+      start := GetTime();
+      for i := 1 to frameCount do
+      begin
+        BeginDrawing();
+        drawScene(userData);
+        EndDrawing();
+      end;
+      frameTime := (GetTime() - start) / frameCount;
+
+      if frameTime <= frameBudget then
+      begin
+        Result := tier;
+        Break;
+      end;
+    end;
+  finally
+    SetTargetFPS(targetFPS);
+  end;
+
+  R3D_ApplyQualityTier(Result);
+end;
+
+function R3D_PROBE_SCHEDULER_BASE(budget: Integer): TR3D_ProbeScheduler;
+begin
+  Result := Default(TR3D_ProbeScheduler);
+  Result.budget := budget;
+end;
+
+procedure R3D_AddScheduledProbe(var scheduler: TR3D_ProbeScheduler; id: TR3D_Probe);
+var
+  i, count: Integer;
+begin
+  if not R3D_IsProbeExist(id) then Exit;
+
+  count := Length(scheduler.probes);
+  for i := 0 to count - 1 do
+    if scheduler.probes[i] = id then Exit;
+
+  SetLength(scheduler.probes, count + 1);
+  SetLength(scheduler.lastUpdate, count + 1);
+  SetLength(scheduler.selected, count + 1);
+
+  scheduler.probes[count] := id;
+  scheduler.lastUpdate[count] := scheduler.frame;
+  scheduler.selected[count] := False;
+
+  R3D_SetProbeUpdateMode(id, R3D_PROBE_UPDATE_ONCE);
+end;
+
+procedure R3D_RemoveScheduledProbe(var scheduler: TR3D_ProbeScheduler; id: TR3D_Probe);
+var
+  i, last: Integer;
+begin
+  last := High(scheduler.probes);
+  for i := 0 to last do
+  begin
+    if scheduler.probes[i] <> id then Continue;
+
+    if R3D_IsProbeExist(id) then
+      R3D_SetProbeUpdateMode(id, R3D_PROBE_UPDATE_ONCE);
+
+    // Порядок не важен: переносим последний элемент на место удаляемого
+    scheduler.probes[i] := scheduler.probes[last];
+    scheduler.lastUpdate[i] := scheduler.lastUpdate[last];
+    scheduler.selected[i] := scheduler.selected[last];
+
+    SetLength(scheduler.probes, last);
+    SetLength(scheduler.lastUpdate, last);
+    SetLength(scheduler.selected, last);
+    Exit;
+  end;
+end;
+
+procedure R3D_UpdateProbeScheduler(var scheduler: TR3D_ProbeScheduler; cameraPosition: TVector3);
+var
+  i, n, best: Integer;
+  position: TVector3;
+  dx, dy, dz: Single;
+  priority: array of Single;
+begin
+  Inc(scheduler.frame);
+
+  for i := 0 to High(scheduler.probes) do
+  begin
+    if scheduler.selected[i] then
+    begin
+      R3D_SetProbeUpdateMode(scheduler.probes[i], R3D_PROBE_UPDATE_ONCE);
+      scheduler.selected[i] := False;
+    end;
+  end;
+
+  SetLength(priority, Length(scheduler.probes));
+  for i := 0 to High(scheduler.probes) do
+  begin
+    if not R3D_IsProbeActive(scheduler.probes[i]) then
+    begin
+      priority[i] := -1.0;
+      Continue;
+    end;
+
+    position := R3D_GetProbePosition(scheduler.probes[i]);
+    dx := position.x - cameraPosition.x;
+    dy := position.y - cameraPosition.y;
+    dz := position.z - cameraPosition.z;
+
+    priority[i] := (scheduler.frame - scheduler.lastUpdate[i]) / (1.0 + Sqrt(dx*dx + dy*dy + dz*dz));
+  end;
+
+  for n := 1 to scheduler.budget do
+  begin
+    best := -1;
+    for i := 0 to High(priority) do
+      if (priority[i] >= 0.0) and ((best < 0) or (priority[i] > priority[best])) then
+        best := i;
+
+    if best < 0 then Break;
+
+    R3D_SetProbeUpdateMode(scheduler.probes[best], R3D_PROBE_UPDATE_ALWAYS);
+    scheduler.selected[best] := True;
+    scheduler.lastUpdate[best] := scheduler.frame;
+    priority[best] := -1.0;
+  end;
+end;
+
+type
+  TR3D_PanoramaJob = record
+    source: PSingle;        // R32G32B32 panorama
+    sourceWidth: Integer;
+    sourceHeight: Integer;
+    dest: PSingle;          // R32G32B32 faces, vertical line
+    size: Integer;
+    firstRow: Integer;      // rows of the destination image to fill
+    lastRow: Integer;
+  end;
+
+  TR3D_PanoramaThread = class(TThread)
+  private
+    FJob: TR3D_PanoramaJob;
+  protected
+    procedure Execute; override;
+  public
+    constructor Create(const job: TR3D_PanoramaJob);
+  end;
+
+procedure R3D_ResamplePanoramaRows(const job: TR3D_PanoramaJob);
+var
+  row, face, x, c: Integer;
+  x0, x1, y0, y1: Integer;
+  sc, tc, dx, dy, dz, u, v, fx, fy, tx, ty: Single;
+  src, dst: PSingle;
+begin
+  src := job.source;
+  for row := job.firstRow to job.lastRow do
+  begin
+    face := row div job.size;
+    tc := 2.0 * ((row mod job.size) + 0.5) / job.size - 1.0;
+    dst := job.dest + row * job.size * 3;
+
+    for x := 0 to job.size - 1 do
+    begin
+      sc := 2.0 * (x + 0.5) / job.size - 1.0;
+
+      // Направления граней в порядке OpenGL: +X, -X, +Y, -Y, +Z, -Z
+      case face of
+        0: begin dx :=  1.0; dy := -tc;  dz := -sc;  end;
+        1: begin dx := -1.0; dy := -tc;  dz :=  sc;  end;
+        2: begin dx :=  sc;  dy :=  1.0; dz :=  tc;  end;
+        3: begin dx :=  sc;  dy := -1.0; dz := -tc;  end;
+        4: begin dx :=  sc;  dy := -tc;  dz :=  1.0; end;
+      else
+        begin dx := -sc; dy := -tc; dz := -1.0; end;
+      end;
+
+      u := 0.5 + ArcTan2(dz, dx) / (2.0 * Pi);
+      v := ArcCos(EnsureRange(dy / Sqrt(dx*dx + dy*dy + dz*dz), -1.0, 1.0)) / Pi;
+
+      // Билинейная выборка: повтор по горизонтали, ограничение по вертикали
+      fx := u * job.sourceWidth - 0.5;
+      fy := v * job.sourceHeight - 0.5;
+      x0 := Floor(fx);
+      y0 := Floor(fy);
+      tx := fx - x0;
+      ty := fy - y0;
+
+      x1 := (x0 + 1) mod job.sourceWidth;
+      x0 := (x0 + job.sourceWidth) mod job.sourceWidth;
+      y1 := EnsureRange(y0 + 1, 0, job.sourceHeight - 1);
+      y0 := EnsureRange(y0, 0, job.sourceHeight - 1);
+
+      for c := 0 to 2 do
+      begin
+        dst[x * 3 + c] :=
+          (src[(y0 * job.sourceWidth + x0) * 3 + c] * (1.0 - tx) + src[(y0 * job.sourceWidth + x1) * 3 + c] * tx) * (1.0 - ty) +
+          (src[(y1 * job.sourceWidth + x0) * 3 + c] * (1.0 - tx) + src[(y1 * job.sourceWidth + x1) * 3 + c] * tx) * ty;
+      end;
+    end;
+  end;
+end;
+
+constructor TR3D_PanoramaThread.Create(const job: TR3D_PanoramaJob);
+begin
+  FJob := job;
+  inherited Create(False);
+end;
+
+procedure TR3D_PanoramaThread.Execute;
+begin
+  R3D_ResamplePanoramaRows(FJob);
+end;
+
+function R3D_GenCubemapImageFromPanorama(panorama: TImage; size: Integer; threadCount: Integer): TImage;
+var
+  source: TImage;
+  job: TR3D_PanoramaJob;
+  threads: array of TR3D_PanoramaThread;
+  rowCount, rowsPerThread, i: Integer;
+begin
+  Result := Default(TImage);
+  if (panorama.data = nil) or (panorama.width <= 0) or (panorama.height <= 0) then Exit;
+
+  if size <= 0 then size := panorama.width div 4;
+  if size <= 0 then Exit;
+
+  source := panorama;
+  if Ord(panorama.format) <> Ord(PIXELFORMAT_UNCOMPRESSED_R32G32B32) then
+  begin
+    source := ImageCopy(panorama);
+    ImageFormat(@source, PIXELFORMAT_UNCOMPRESSED_R32G32B32);
+  end;
+
+  Result := GenImageColor(size, 6 * size, BLACK);
+  ImageFormat(@Result, PIXELFORMAT_UNCOMPRESSED_R32G32B32);
+
+  job.source := PSingle(source.data);
+  job.sourceWidth := source.width;
+  job.sourceHeight := source.height;
+  job.dest := PSingle(Result.data);
+  job.size := size;
+
+  rowCount := 6 * size;
+  if threadCount <= 0 then threadCount := TThread.ProcessorCount;
+  if threadCount > rowCount then threadCount := rowCount;
+  if threadCount < 1 then threadCount := 1;
+  rowsPerThread := (rowCount + threadCount - 1) div threadCount;
+
+  // Последний блок строк обрабатывается вызывающим потоком
+  SetLength(threads, threadCount - 1);
+  for i := 0 to High(threads) do
+  begin
+    job.firstRow := i * rowsPerThread;
+    job.lastRow := Min(job.firstRow + rowsPerThread, rowCount) - 1;
+    threads[i] := TR3D_PanoramaThread.Create(job);
+  end;
+
+  job.firstRow := (threadCount - 1) * rowsPerThread;
+  job.lastRow := rowCount - 1;
+  if job.firstRow <= job.lastRow then R3D_ResamplePanoramaRows(job);
+
+  for i := 0 to High(threads) do
+  begin
+    threads[i].WaitFor;
+    threads[i].Free;
+  end;
+
+  if source.data <> panorama.data then UnloadImage(source);
+end;
+
+function R3D_LoadCubemapFromPanorama(fileName: PChar; size: Integer; threadCount: Integer): TR3D_Cubemap;
+var
+  panorama, faces: TImage;
+begin
+  Result := Default(TR3D_Cubemap);
+
+  panorama := LoadImage(fileName);
+  if panorama.data = nil then Exit;
+
+  faces := R3D_GenCubemapImageFromPanorama(panorama, size, threadCount);
+  UnloadImage(panorama);
+  if faces.data = nil then Exit;
+
+  Result := R3D_LoadCubemapFromImage(faces, R3D_CUBEMAP_LAYOUT_LINE_VERTICAL);
+  UnloadImage(faces);
+end;
+
+function R3D_LoadAmbientMapFromPanorama(fileName: PChar; size: Integer; flags: TR3D_AmbientFlags;
+  threadCount: Integer): TR3D_AmbientMap;
+var
+  panorama, faces: TImage;
+begin
+  Result := Default(TR3D_AmbientMap);
+
+  panorama := LoadImage(fileName);
+  if panorama.data = nil then Exit;
+
+  faces := R3D_GenCubemapImageFromPanorama(panorama, size, threadCount);
+  UnloadImage(panorama);
+  if faces.data = nil then Exit;
+
+  Result := R3D_LoadAmbientMapFromImage(faces, R3D_CUBEMAP_LAYOUT_LINE_VERTICAL, flags);
+  UnloadImage(faces);
+end;
+
+type
+  TR3D_TextureCacheEntry = record
+    key: string;
+    texture: TTexture2D;
+    refCount: Integer;
+  end;
+
+var
+  R3D_TextureCache: array of TR3D_TextureCacheEntry;
+
+function R3D_TextureCacheFileKey(const kind: string; fileName: PChar): string;
+begin
+  Result := kind + ':file:' + ExpandFileName(string(fileName));
+end;
+
+{$PUSH}{$Q-}{$R-}
+function R3D_TextureCacheMemoryKey(const kind: string; fileType: PChar; fileData: Pointer; dataSize: Integer): string;
+var
+  hash: QWord;
+  data: PByte;
+  i: Integer;
+begin
+  // FNV-1a 64
+  hash := QWord($CBF29CE484222325);
+  data := PByte(fileData);
+  for i := 0 to dataSize - 1 do
+  begin
+    hash := hash xor data[i];
+    hash := hash * QWord($100000001B3);
+  end;
+  Result := Format('%s:mem:%s:%d:%s', [kind, string(fileType), dataSize, IntToHex(hash, 16)]);
+end;
+{$POP}
+
+function R3D_AcquireCachedTexture(const key: string; out texture: TTexture2D): Boolean;
+var
+  i: Integer;
+begin
+  for i := 0 to High(R3D_TextureCache) do
+  begin
+    if R3D_TextureCache[i].key = key then
+    begin
+      Inc(R3D_TextureCache[i].refCount);
+      texture := R3D_TextureCache[i].texture;
+      Exit(True);
+    end;
+  end;
+  texture := Default(TTexture2D);
+  Result := False;
+end;
+
+procedure R3D_StoreCachedTexture(const key: string; texture: TTexture2D);
+var
+  count: Integer;
+begin
+  if texture.id = 0 then Exit;
+
+  count := Length(R3D_TextureCache);
+  SetLength(R3D_TextureCache, count + 1);
+  R3D_TextureCache[count].key := key;
+  R3D_TextureCache[count].texture := texture;
+  R3D_TextureCache[count].refCount := 1;
+end;
+
+procedure R3D_ReleaseCachedTexture(texture: TTexture2D);
+var
+  i, last: Integer;
+begin
+  if texture.id = 0 then Exit;
+
+  last := High(R3D_TextureCache);
+  for i := 0 to last do
+  begin
+    if R3D_TextureCache[i].texture.id <> texture.id then Continue;
+
+    Dec(R3D_TextureCache[i].refCount);
+    if R3D_TextureCache[i].refCount > 0 then Exit;
+
+    UnloadTexture(R3D_TextureCache[i].texture);
+    R3D_TextureCache[i] := R3D_TextureCache[last];
+    SetLength(R3D_TextureCache, last);
+    Exit;
+  end;
+end;
+
+function R3D_LoadAlbedoMapCached(const fileName: PChar; color: TColor): TR3D_AlbedoMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheFileKey('albedo', fileName);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.color := color;
+    Exit;
+  end;
+  Result := R3D_LoadAlbedoMap(fileName, color);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadAlbedoMapFromMemoryCached(fileType: PChar; fileData: Pointer;
+  dataSize: Integer; color: TColor): TR3D_AlbedoMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheMemoryKey('albedo', fileType, fileData, dataSize);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.color := color;
+    Exit;
+  end;
+  Result := R3D_LoadAlbedoMapFromMemory(fileType, fileData, dataSize, color);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadEmissionMapCached(fileName: PChar; color: TColor; energy: Single): TR3D_EmissionMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheFileKey('emission', fileName);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.color := color;
+    Result.energy := energy;
+    Exit;
+  end;
+  Result := R3D_LoadEmissionMap(fileName, color, energy);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadEmissionMapFromMemoryCached(fileType: PChar; fileData: Pointer;
+  dataSize: Integer; color: TColor; energy: Single): TR3D_EmissionMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheMemoryKey('emission', fileType, fileData, dataSize);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.color := color;
+    Result.energy := energy;
+    Exit;
+  end;
+  Result := R3D_LoadEmissionMapFromMemory(fileType, fileData, dataSize, color, energy);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadNormalMapCached(fileName: PChar; scale: Single): TR3D_NormalMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheFileKey('normal', fileName);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.scale := scale;
+    Exit;
+  end;
+  Result := R3D_LoadNormalMap(fileName, scale);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadNormalMapFromMemoryCached(fileType: PChar; fileData: Pointer;
+  dataSize: Integer; scale: Single): TR3D_NormalMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheMemoryKey('normal', fileType, fileData, dataSize);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.scale := scale;
+    Exit;
+  end;
+  Result := R3D_LoadNormalMapFromMemory(fileType, fileData, dataSize, scale);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadOrmMapCached(fileName: PChar; occlusion, roughness, metalness: Single): TR3D_OrmMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheFileKey('orm', fileName);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.occlusion := occlusion;
+    Result.roughness := roughness;
+    Result.metalness := metalness;
+    Exit;
+  end;
+  Result := R3D_LoadOrmMap(fileName, occlusion, roughness, metalness);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+function R3D_LoadOrmMapFromMemoryCached(fileType: PChar; fileData: Pointer; dataSize: Integer;
+  occlusion, roughness, metalness: Single): TR3D_OrmMap;
+var
+  key: string;
+begin
+  key := R3D_TextureCacheMemoryKey('orm', fileType, fileData, dataSize);
+  if R3D_AcquireCachedTexture(key, Result.texture) then
+  begin
+    Result.occlusion := occlusion;
+    Result.roughness := roughness;
+    Result.metalness := metalness;
+    Exit;
+  end;
+  Result := R3D_LoadOrmMapFromMemory(fileType, fileData, dataSize, occlusion, roughness, metalness);
+  R3D_StoreCachedTexture(key, Result.texture);
+end;
+
+procedure R3D_UnloadAlbedoMapCached(map: TR3D_AlbedoMap);
+begin
+  R3D_ReleaseCachedTexture(map.texture);
+end;
+
+procedure R3D_UnloadEmissionMapCached(map: TR3D_EmissionMap);
+begin
+  R3D_ReleaseCachedTexture(map.texture);
+end;
+
+procedure R3D_UnloadNormalMapCached(map: TR3D_NormalMap);
+begin
+  R3D_ReleaseCachedTexture(map.texture);
+end;
+
+procedure R3D_UnloadOrmMapCached(map: TR3D_OrmMap);
+begin
+  R3D_ReleaseCachedTexture(map.texture);
+end;
+
+procedure R3D_UnloadMaterialCached(material: TR3D_Material);
+begin
+  R3D_ReleaseCachedTexture(material.albedo.texture);
+  R3D_ReleaseCachedTexture(material.emission.texture);
+  R3D_ReleaseCachedTexture(material.normal.texture);
+  R3D_ReleaseCachedTexture(material.orm.texture);
+end;
+
+function R3D_GetTextureCacheCount: Integer;
+begin
+  Result := Length(R3D_TextureCache);
+end;
+
+type
+  TR3D_DDSHeader = packed record
+    magic: array[0..3] of AnsiChar;
+    size: LongWord;
+    flags: LongWord;
+    height: LongWord;
+    width: LongWord;
+    pitchOrLinearSize: LongWord;
+    depth: LongWord;
+    mipMapCount: LongWord;
+    reserved1: array[0..10] of LongWord;
+    pfSize: LongWord;
+    pfFlags: LongWord;
+    pfFourCC: LongWord;
+    pfRGBBitCount: LongWord;
+    pfRBitMask: LongWord;
+    pfGBitMask: LongWord;
+    pfBBitMask: LongWord;
+    pfABitMask: LongWord;
+    caps: LongWord;
+    caps2: LongWord;
+    caps3: LongWord;
+    caps4: LongWord;
+    reserved2: LongWord;
+  end;
+
+function R3D_EncodeImageDDS(image: TImage; out dataSize: Integer): Pointer;
+var
+  rgba: TImage;
+  header: TR3D_DDSHeader;
+  src, dst: PByte;
+  i, pixelCount, levels, level, w, h: Integer;
+  baseSize, chainSize, pixelsSize: Integer;
+begin
+  rgba := image;
+  if Ord(image.format) <> Ord(PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) then
+  begin
+    rgba := ImageCopy(image);
+    ImageFormat(@rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+  end;
+
+  pixelCount := rgba.width * rgba.height;
+  baseSize := pixelCount * 4;
+
+  levels := Max(rgba.mipmaps, 1);
+  chainSize := 0;
+  w := rgba.width;
+  h := rgba.height;
+  for level := 0 to levels - 1 do
+  begin
+    Inc(chainSize, w * h * 4);
+    w := Max(w div 2, 1);
+    h := Max(h div 2, 1);
+  end;
+
+  // raylib читает цепочку мипмапов ровно как base + base/3 байт; у сильно вытянутых
+  // изображений цепочка туда не помещается, их пишем только базовым уровнем
+  pixelsSize := baseSize;
+  if levels > 1 then
+  begin
+    if chainSize <= baseSize + baseSize div 3 then
+      pixelsSize := baseSize + baseSize div 3
+    else
+    begin
+      levels := 1;
+      chainSize := baseSize;
+    end;
+  end;
+
+  header := Default(TR3D_DDSHeader);
+  header.magic := 'DDS ';
+  header.size := 124;
+  header.flags := $100F;            // CAPS | HEIGHT | WIDTH | PITCH | PIXELFORMAT
+  header.height := rgba.height;
+  header.width := rgba.width;
+  header.pitchOrLinearSize := rgba.width * 4;
+  header.mipMapCount := levels;
+  header.pfSize := 32;
+  header.pfFlags := $41;            // RGB | ALPHAPIXELS
+  header.pfRGBBitCount := 32;
+  header.pfRBitMask := $00FF0000;
+  header.pfGBitMask := $0000FF00;
+  header.pfBBitMask := $000000FF;
+  header.pfABitMask := $FF000000;
+  header.caps := $1000;             // TEXTURE
+  if levels > 1 then
+  begin
+    header.flags := header.flags or $20000;   // MIPMAPCOUNT
+    header.caps := header.caps or $400008;    // MIPMAP | COMPLEX
+  end;
+
+  dataSize := SizeOf(header) + pixelsSize;
+  GetMem(Result, dataSize);
+  FillChar(Result^, dataSize, 0);
+  Move(header, Result^, SizeOf(header));
+
+  // Загрузчик DDS в raylib ожидает порядок байтов B8G8R8A8 для 32-битных данных,
+  // но переставляет каналы только у базового уровня: остальные уровни пишем как RGBA
+  src := PByte(rgba.data);
+  dst := PByte(Result) + SizeOf(header);
+  for i := 0 to pixelCount - 1 do
+  begin
+    dst[i * 4]     := src[i * 4 + 2];
+    dst[i * 4 + 1] := src[i * 4 + 1];
+    dst[i * 4 + 2] := src[i * 4];
+    dst[i * 4 + 3] := src[i * 4 + 3];
+  end;
+  if chainSize > baseSize then
+    Move(src[baseSize], dst[baseSize], chainSize - baseSize);
+
+  if rgba.data <> image.data then UnloadImage(rgba);
+end;
+
+const
+  R3D_ASYNC_QUEUED   = 0;
+  R3D_ASYNC_DECODING = 1;
+  R3D_ASYNC_DECODED  = 2;
+  R3D_ASYNC_UPLOADED = 3;
+  R3D_ASYNC_FAILED   = 4;
+
+type
+  TR3D_AsyncMapKind = (R3D_ASYNC_ALBEDO, R3D_ASYNC_EMISSION, R3D_ASYNC_NORMAL, R3D_ASYNC_ORM);
+
+  TR3D_AsyncTextureJob = class
+    fileName: string;
+    kind: TR3D_AsyncMapKind;
+    state: Integer;
+    released: Boolean;      // handle unloaded while queued, freed by whoever dequeues it
+    data: Pointer;          // DDS-encoded pixels, freed with FreeMem; nil if decoding failed
+    dataSize: Integer;
+    decodedBytes: Integer;
+    texture: TTexture2D;
+  end;
+
+  // Кольцевая FIFO-очередь задач
+  TR3D_AsyncJobQueue = record
+    items: array of TR3D_AsyncTextureJob;
+    head: Integer;
+    count: Integer;
+  end;
+
+  TR3D_AsyncTextureWorker = class(TThread)
+  protected
+    procedure Execute; override;
+  end;
+
+var
+  R3D_AsyncWorkerCount: Integer = 0;
+  R3D_AsyncJobs: array of TR3D_AsyncTextureJob;     // indexed by handle, nil for a free slot
+  R3D_AsyncFreeSlots: array of Integer;
+  R3D_AsyncFreeSlotCount: Integer = 0;
+  R3D_AsyncPending: TR3D_AsyncJobQueue;             // QUEUED, waiting for decoding
+  R3D_AsyncDecoded: TR3D_AsyncJobQueue;             // DECODED, waiting for upload
+  R3D_AsyncWorkers: array of TR3D_AsyncTextureWorker;
+  R3D_AsyncLock: TRTLCriticalSection;
+  R3D_AsyncEvent: PRTLEvent;
+
+procedure R3D_PushAsyncJob(var queue: TR3D_AsyncJobQueue; job: TR3D_AsyncTextureJob);
+var
+  items: array of TR3D_AsyncTextureJob;
+  i: Integer;
+begin
+  if queue.count = Length(queue.items) then
+  begin
+    SetLength(items, Max(16, Length(queue.items) * 2));
+    for i := 0 to queue.count - 1 do
+      items[i] := queue.items[(queue.head + i) mod Length(queue.items)];
+    queue.items := items;
+    queue.head := 0;
+  end;
+
+  queue.items[(queue.head + queue.count) mod Length(queue.items)] := job;
+  Inc(queue.count);
+end;
+
+function R3D_PeekAsyncJob(const queue: TR3D_AsyncJobQueue): TR3D_AsyncTextureJob;
+begin
+  if queue.count = 0 then Exit(nil);
+  Result := queue.items[queue.head];
+end;
+
+function R3D_PopAsyncJob(var queue: TR3D_AsyncJobQueue): TR3D_AsyncTextureJob;
+begin
+  if queue.count = 0 then Exit(nil);
+  Result := queue.items[queue.head];
+  queue.items[queue.head] := nil;
+  queue.head := (queue.head + 1) mod Length(queue.items);
+  Dec(queue.count);
+end;
+
+procedure R3D_FreeAsyncJob(job: TR3D_AsyncTextureJob);
+begin
+  if job.data <> nil then FreeMem(job.data);
+  job.Free;
+end;
+
+// Декодирование выполняется в рабочем потоке, а результат упаковывается в несжатый DDS:
+// загрузка на GPU в основном потоке проходит через R3D_Load*MapFromMemory(), где raylib
+// только копирует пиксели, с тем же цветовым пространством, что и синхронная загрузка.
+// Ошибку декодирования (data = nil) переводит в FAILED уже основной поток.
+procedure R3D_DecodeAsyncJob(job: TR3D_AsyncTextureJob);
+var
+  image: TImage;
+  data: Pointer;
+  dataSize, decodedBytes: Integer;
+begin
+  data := nil;
+  dataSize := 0;
+  decodedBytes := 0;
+
+  image := LoadImage(PChar(job.fileName));
+  if image.data <> nil then
+  begin
+    // Цепочка мипмапов строится здесь же, чтобы libr3d не вызывал glGenerateMipmap при загрузке
+    ImageMipmaps(@image);
+    data := R3D_EncodeImageDDS(image, dataSize);
+    decodedBytes := dataSize;
+    UnloadImage(image);
+  end;
+
+  EnterCriticalSection(R3D_AsyncLock);
+  job.data := data;
+  job.dataSize := dataSize;
+  job.decodedBytes := decodedBytes;
+  job.state := R3D_ASYNC_DECODED;
+  R3D_PushAsyncJob(R3D_AsyncDecoded, job);
+  LeaveCriticalSection(R3D_AsyncLock);
+end;
+
+procedure TR3D_AsyncTextureWorker.Execute;
+var
+  job: TR3D_AsyncTextureJob;
+  released: Boolean;
+begin
+  while not Terminated do
+  begin
+    released := False;
+
+    EnterCriticalSection(R3D_AsyncLock);
+    job := R3D_PopAsyncJob(R3D_AsyncPending);
+    if job <> nil then
+    begin
+      released := job.released;
+      if not released then job.state := R3D_ASYNC_DECODING;
+    end;
+    LeaveCriticalSection(R3D_AsyncLock);
+
+    if job = nil then RTLEventWaitFor(R3D_AsyncEvent, 100)
+    else if released then R3D_FreeAsyncJob(job)
+    else R3D_DecodeAsyncJob(job);
+  end;
+end;
+
+function R3D_QueueAsyncTexture(fileName: PChar; kind: TR3D_AsyncMapKind): TR3D_AsyncTexture;
+var
+  job: TR3D_AsyncTextureJob;
+  i, workerCount: Integer;
+begin
+  if R3D_AsyncEvent = nil then
+  begin
+    InitCriticalSection(R3D_AsyncLock);
+    R3D_AsyncEvent := RTLEventCreate;
+
+    workerCount := R3D_AsyncWorkerCount;
+    if workerCount < 0 then
+    begin
+      workerCount := TThread.ProcessorCount - 1;
+      if workerCount < 1 then workerCount := 1;
+    end;
+
+    SetLength(R3D_AsyncWorkers, workerCount);
+    for i := 0 to workerCount - 1 do
+      R3D_AsyncWorkers[i] := TR3D_AsyncTextureWorker.Create(False);
+  end;
+
+  job := TR3D_AsyncTextureJob.Create;
+  job.fileName := string(fileName);
+  job.kind := kind;
+  job.state := R3D_ASYNC_QUEUED;
+
+  // Таблица дескрипторов меняется только в основном потоке, рабочие видят лишь очереди
+  if R3D_AsyncFreeSlotCount > 0 then
+  begin
+    Dec(R3D_AsyncFreeSlotCount);
+    Result := R3D_AsyncFreeSlots[R3D_AsyncFreeSlotCount];
+  end
+  else
+  begin
+    Result := Length(R3D_AsyncJobs);
+    SetLength(R3D_AsyncJobs, Result + 1);
+  end;
+  R3D_AsyncJobs[Result] := job;
+
+  EnterCriticalSection(R3D_AsyncLock);
+  R3D_PushAsyncJob(R3D_AsyncPending, job);
+  LeaveCriticalSection(R3D_AsyncLock);
+
+  RTLEventSetEvent(R3D_AsyncEvent);
+end;
+
+function R3D_LoadAlbedoMapAsync(fileName: PChar): TR3D_AsyncTexture;
+begin
+  Result := R3D_QueueAsyncTexture(fileName, R3D_ASYNC_ALBEDO);
+end;
+
+function R3D_LoadEmissionMapAsync(fileName: PChar): TR3D_AsyncTexture;
+begin
+  Result := R3D_QueueAsyncTexture(fileName, R3D_ASYNC_EMISSION);
+end;
+
+function R3D_LoadNormalMapAsync(fileName: PChar): TR3D_AsyncTexture;
+begin
+  Result := R3D_QueueAsyncTexture(fileName, R3D_ASYNC_NORMAL);
+end;
+
+function R3D_LoadOrmMapAsync(fileName: PChar): TR3D_AsyncTexture;
+begin
+  Result := R3D_QueueAsyncTexture(fileName, R3D_ASYNC_ORM);
+end;
+
+procedure R3D_SetAsyncTextureWorkers(count: Integer);
+begin
+  if R3D_AsyncEvent <> nil then Exit;
+  R3D_AsyncWorkerCount := count;
+end;
+
+procedure R3D_UpdateAsyncTextures(byteBudget: Integer);
+var
+  spent: Integer;
+  job: TR3D_AsyncTextureJob;
+begin
+  if R3D_AsyncEvent = nil then Exit;
+
+  // Без рабочих потоков декодирование выполняется здесь, в пределах того же бюджета
+  if Length(R3D_AsyncWorkers) = 0 then
+  begin
+    spent := 0;
+    while (spent = 0) or (spent < byteBudget) do
+    begin
+      EnterCriticalSection(R3D_AsyncLock);
+      job := R3D_PopAsyncJob(R3D_AsyncPending);
+      LeaveCriticalSection(R3D_AsyncLock);
+      if job = nil then Break;
+
+      if job.released then
+      begin
+        R3D_FreeAsyncJob(job);
+        Continue;
+      end;
+
+      job.state := R3D_ASYNC_DECODING;
+      R3D_DecodeAsyncJob(job);
+      Inc(spent, job.decodedBytes);
+    end;
+  end;
+
+  // Задачи из очереди декодированных принадлежат только основному потоку
+  spent := 0;
+  while True do
+  begin
+    EnterCriticalSection(R3D_AsyncLock);
+    job := R3D_PeekAsyncJob(R3D_AsyncDecoded);
+    if (job <> nil) and (not job.released) and (job.data <> nil) and
+       (spent > 0) and (spent + job.decodedBytes > byteBudget) then job := nil;
+    if job <> nil then R3D_PopAsyncJob(R3D_AsyncDecoded);
+    LeaveCriticalSection(R3D_AsyncLock);
+    if job = nil then Break;
+
+    if job.released then
+    begin
+      R3D_FreeAsyncJob(job);
+      Continue;
+    end;
+
+    if job.data = nil then
+    begin
+      job.state := R3D_ASYNC_FAILED;
+      Continue;
+    end;
+
+    case job.kind of
+      R3D_ASYNC_ALBEDO:   job.texture := R3D_LoadAlbedoMapFromMemory('.dds', job.data, job.dataSize, WHITE).texture;
+      R3D_ASYNC_EMISSION: job.texture := R3D_LoadEmissionMapFromMemory('.dds', job.data, job.dataSize, WHITE, 1.0).texture;
+      R3D_ASYNC_NORMAL:   job.texture := R3D_LoadNormalMapFromMemory('.dds', job.data, job.dataSize, 1.0).texture;
+      R3D_ASYNC_ORM:      job.texture := R3D_LoadOrmMapFromMemory('.dds', job.data, job.dataSize, 1.0, 1.0, 0.0).texture;
+    end;
+
+    FreeMem(job.data);
+    job.data := nil;
+    Inc(spent, job.decodedBytes);
+
+    if job.texture.id <> 0 then job.state := R3D_ASYNC_UPLOADED
+    else job.state := R3D_ASYNC_FAILED;
+  end;
+end;
+
+function R3D_GetAsyncTexture(handle: TR3D_AsyncTexture): TTexture2D;
+var
+  job: TR3D_AsyncTextureJob;
+begin
+  Result := Default(TTexture2D);
+  if (handle < 0) or (handle > High(R3D_AsyncJobs)) then Exit;
+
+  job := R3D_AsyncJobs[handle];
+  if job = nil then Exit;
+
+  if job.state = R3D_ASYNC_UPLOADED then Exit(job.texture);
+
+  case job.kind of
+    R3D_ASYNC_EMISSION: Result := R3D_GetBlackTexture();
+    R3D_ASYNC_NORMAL:   Result := R3D_GetNormalTexture();
+  else
+    Result := R3D_GetWhiteTexture();
+  end;
+end;
+
+function R3D_IsAsyncTextureReady(handle: TR3D_AsyncTexture): Boolean;
+begin
+  Result := (handle >= 0) and (handle <= High(R3D_AsyncJobs))
+    and (R3D_AsyncJobs[handle] <> nil)
+    and (R3D_AsyncJobs[handle].state = R3D_ASYNC_UPLOADED);
+end;
+
+function R3D_GetAsyncTextureState(handle: TR3D_AsyncTexture): TR3D_AsyncTextureState;
+begin
+  Result := R3D_ASYNC_TEXTURE_INVALID;
+  if (handle < 0) or (handle > High(R3D_AsyncJobs)) or (R3D_AsyncJobs[handle] = nil) then Exit;
+
+  case R3D_AsyncJobs[handle].state of
+    R3D_ASYNC_UPLOADED: Result := R3D_ASYNC_TEXTURE_READY;
+    R3D_ASYNC_FAILED:   Result := R3D_ASYNC_TEXTURE_FAILED;
+  else
+    Result := R3D_ASYNC_TEXTURE_PENDING;
+  end;
+end;
+
+procedure R3D_UnloadAsyncTexture(handle: TR3D_AsyncTexture);
+var
+  job: TR3D_AsyncTextureJob;
+begin
+  if (handle < 0) or (handle > High(R3D_AsyncJobs)) or (R3D_AsyncJobs[handle] = nil) then Exit;
+
+  job := R3D_AsyncJobs[handle];
+  R3D_AsyncJobs[handle] := nil;
+
+  if R3D_AsyncFreeSlotCount = Length(R3D_AsyncFreeSlots) then
+    SetLength(R3D_AsyncFreeSlots, Max(16, Length(R3D_AsyncFreeSlots) * 2));
+  R3D_AsyncFreeSlots[R3D_AsyncFreeSlotCount] := handle;
+  Inc(R3D_AsyncFreeSlotCount);
+
+  // Задача ещё в очереди или у рабочего потока: её освободит тот, кто извлечёт её из очереди
+  EnterCriticalSection(R3D_AsyncLock);
+  if job.state in [R3D_ASYNC_QUEUED, R3D_ASYNC_DECODING, R3D_ASYNC_DECODED] then
+  begin
+    job.released := True;
+    job := nil;
+  end;
+  LeaveCriticalSection(R3D_AsyncLock);
+
+  if job = nil then Exit;
+
+  if job.state = R3D_ASYNC_UPLOADED then UnloadTexture(job.texture);
+  R3D_FreeAsyncJob(job);
+end;
+
+procedure R3D_FreeReleasedAsyncJobs(var queue: TR3D_AsyncJobQueue);
+var
+  job: TR3D_AsyncTextureJob;
+begin
+  job := R3D_PopAsyncJob(queue);
+  while job <> nil do
+  begin
+    // Задачи с живым дескриптором освобождаются через таблицу R3D_AsyncJobs
+    if job.released then R3D_FreeAsyncJob(job);
+    job := R3D_PopAsyncJob(queue);
+  end;
+  queue := Default(TR3D_AsyncJobQueue);
+end;
+
+procedure R3D_ShutdownAsyncTextures;
+var
+  i: Integer;
+begin
+  if R3D_AsyncEvent = nil then Exit;
+
+  for i := 0 to High(R3D_AsyncWorkers) do
+    R3D_AsyncWorkers[i].Terminate;
+  for i := 0 to High(R3D_AsyncWorkers) do
+  begin
+    RTLEventSetEvent(R3D_AsyncEvent);
+    R3D_AsyncWorkers[i].WaitFor;
+    R3D_AsyncWorkers[i].Free;
+  end;
+  R3D_AsyncWorkers := nil;
+
+  R3D_FreeReleasedAsyncJobs(R3D_AsyncPending);
+  R3D_FreeReleasedAsyncJobs(R3D_AsyncDecoded);
+
+  for i := 0 to High(R3D_AsyncJobs) do
+    if R3D_AsyncJobs[i] <> nil then R3D_FreeAsyncJob(R3D_AsyncJobs[i]);
+  R3D_AsyncJobs := nil;
+  R3D_AsyncFreeSlots := nil;
+  R3D_AsyncFreeSlotCount := 0;
+
+  RTLEventDestroy(R3D_AsyncEvent);
+  R3D_AsyncEvent := nil;
+  DoneCriticalSection(R3D_AsyncLock);
+end;
+
+function R3D_CookTexture(srcFileName, dstFileName: PChar): Boolean;
+var
+  image: TImage;
+  data: Pointer;
+  dataSize: Integer;
+  tempFileName: string;
+  stream: TFileStream;
+begin
+  Result := False;
+  if not FileExists(string(srcFileName)) then Exit;
+
+  if FileExists(string(dstFileName)) and
+     (FileAge(string(dstFileName)) >= FileAge(string(srcFileName))) then Exit(True);
+
+  image := LoadImage(srcFileName);
+  if image.data = nil then Exit;
+  ImageMipmaps(@image);
+
+  // Пишем во временный файл и переименовываем только после успешной записи,
+  // иначе обрезанный файл оказался бы новее исходника и считался бы готовым
+  data := nil;
+  tempFileName := string(dstFileName) + '.tmp';
+  try
+    data := R3D_EncodeImageDDS(image, dataSize);
+    try
+      stream := TFileStream.Create(tempFileName, fmCreate);
+      try
+        stream.WriteBuffer(data^, dataSize);
+      finally
+        stream.Free;
+      end;
+
+      if FileExists(string(dstFileName)) then DeleteFile(string(dstFileName));
+      Result := RenameFile(tempFileName, string(dstFileName));
+    except
+      on EStreamError do Result := False;
+    end;
+  finally
+    if not Result then DeleteFile(tempFileName);
+    if data <> nil then FreeMem(data);
+    UnloadImage(image);
+  end;
+end;
+
+function R3D_MapTextureFile(fileName: PChar; out dataSize: Integer): Pointer;
+{$IFDEF UNIX}
+var
+  fd: cint;
+  info: Stat;
+begin
+  Result := nil;
+  dataSize := 0;
+
+  fd := FpOpen(fileName, O_RDONLY);
+  if fd < 0 then Exit;
+
+  if (FpFStat(fd, info) = 0) and (info.st_size > 0) then
+  begin
+    Result := FpMmap(nil, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if Result = MAP_FAILED then Result := nil
+    else dataSize := info.st_size;
+  end;
+
+  FpClose(fd);
+end;
+{$ELSE}
+var
+  stream: TFileStream;
+begin
+  Result := nil;
+  dataSize := 0;
+  if not FileExists(string(fileName)) then Exit;
+
+  stream := TFileStream.Create(string(fileName), fmOpenRead or fmShareDenyWrite);
+  try
+    dataSize := stream.Size;
+    if dataSize > 0 then
+    begin
+      GetMem(Result, dataSize);
+      stream.ReadBuffer(Result^, dataSize);
+    end;
+  finally
+    stream.Free;
+  end;
+end;
+{$ENDIF}
+
+procedure R3D_UnmapTextureFile(data: Pointer; dataSize: Integer);
+begin
+  if data = nil then Exit;
+  {$IFDEF UNIX}
+  FpMunmap(data, dataSize);
+  {$ELSE}
+  FreeMem(data);
+  {$ENDIF}
+end;
+
+// Типизированные версии без разбора строк
+procedure R3D_ENVIRONMENT_SET(Field: TR3D_EnvFloatField; Value: Single);
+var
+  Env: PR3D_Environment;
+begin
+  Env := R3D_GetEnvironment();
+  if not Assigned(Env) then Exit;
+
+  case Field of
+    R3D_ENV_BACKGROUND_ENERGY: Env^.background.energy := Value;
+    R3D_ENV_BACKGROUND_SKY_BLUR: Env^.background.skyBlur := Value;
+    R3D_ENV_AMBIENT_ENERGY: Env^.ambient.energy := Value;
+    R3D_ENV_SSAO_INTENSITY: Env^.ssao.intensity := Value;
+    R3D_ENV_SSAO_POWER: Env^.ssao.power := Value;
+    R3D_ENV_SSAO_RADIUS: Env^.ssao.radius := Value;
+    R3D_ENV_SSAO_BIAS: Env^.ssao.bias := Value;
+    R3D_ENV_SSIL_SAMPLE_RADIUS: Env^.ssil.sampleRadius := Value;
+    R3D_ENV_SSIL_HIT_THICKNESS: Env^.ssil.hitThickness := Value;
+    R3D_ENV_SSIL_AO_POWER: Env^.ssil.aoPower := Value;
+    R3D_ENV_SSIL_ENERGY: Env^.ssil.energy := Value;
+    R3D_ENV_SSIL_CONVERGENCE: Env^.ssil.convergence := Value;
+    R3D_ENV_SSIL_BOUNCE: Env^.ssil.bounce := Value;
+    R3D_ENV_BLOOM_LEVELS: Env^.bloom.levels := Value;
+    R3D_ENV_BLOOM_INTENSITY: Env^.bloom.intensity := Value;
+    R3D_ENV_BLOOM_THRESHOLD: Env^.bloom.threshold := Value;
+    R3D_ENV_BLOOM_SOFT_THRESHOLD: Env^.bloom.softThreshold := Value;
+    R3D_ENV_BLOOM_FILTER_RADIUS: Env^.bloom.filterRadius := Value;
+    R3D_ENV_SSR_RAY_MARCH_LENGTH: Env^.ssr.rayMarchLength := Value;
+    R3D_ENV_SSR_DEPTH_THICKNESS: Env^.ssr.depthThickness := Value;
+    R3D_ENV_SSR_DEPTH_TOLERANCE: Env^.ssr.depthTolerance := Value;
+    R3D_ENV_SSR_EDGE_FADE_START: Env^.ssr.edgeFadeStart := Value;
+    R3D_ENV_SSR_EDGE_FADE_END: Env^.ssr.edgeFadeEnd := Value;
+    R3D_ENV_FOG_START: Env^.fog.start := Value;
+    R3D_ENV_FOG_END: Env^.fog.end_ := Value;
+    R3D_ENV_FOG_DENSITY: Env^.fog.density := Value;
+    R3D_ENV_FOG_SKY_AFFECT: Env^.fog.skyAffect := Value;
+    R3D_ENV_DOF_FOCUS_POINT: Env^.dof.focusPoint := Value;
+    R3D_ENV_DOF_FOCUS_SCALE: Env^.dof.focusScale := Value;
+    R3D_ENV_DOF_MAX_BLUR_SIZE: Env^.dof.maxBlurSize := Value;
+    R3D_ENV_TONEMAP_EXPOSURE: Env^.tonemap.exposure := Value;
+    R3D_ENV_TONEMAP_WHITE: Env^.tonemap.white := Value;
+    R3D_ENV_COLOR_BRIGHTNESS: Env^.color.brightness := Value;
+    R3D_ENV_COLOR_CONTRAST: Env^.color.contrast := Value;
+    R3D_ENV_COLOR_SATURATION: Env^.color.saturation := Value;
+  end;
+end;
+
+procedure R3D_ENVIRONMENT_SET(Field: TR3D_EnvIntField; Value: Integer);
+var
+  Env: PR3D_Environment;
+begin
+  Env := R3D_GetEnvironment();
+  if not Assigned(Env) then Exit;
+
+  case Field of
+    R3D_ENV_SSAO_SAMPLE_COUNT: Env^.ssao.sampleCount := Value;
+    R3D_ENV_SSIL_SAMPLE_COUNT: Env^.ssil.sampleCount := Value;
+    R3D_ENV_SSIL_SLICE_COUNT: Env^.ssil.sliceCount := Value;
+    R3D_ENV_SSR_MAX_RAY_STEPS: Env^.ssr.maxRaySteps := Value;
+    R3D_ENV_SSR_BINARY_SEARCH_STEPS: Env^.ssr.binarySearchSteps := Value;
+  end;
+end;
+
+procedure R3D_ENVIRONMENT_SET(Field: TR3D_EnvBoolField; Value: Boolean);
+var
+  Env: PR3D_Environment;
+begin
+  Env := R3D_GetEnvironment();
+  if not Assigned(Env) then Exit;
+
+  case Field of
+    R3D_ENV_SSAO_ENABLED: Env^.ssao.enabled := Value;
+    R3D_ENV_SSIL_ENABLED: Env^.ssil.enabled := Value;
+    R3D_ENV_SSR_ENABLED: Env^.ssr.enabled := Value;
+    R3D_ENV_DOF_DEBUG_MODE: Env^.dof.debugMode := Value;
+  end;
+end;
+
 // Реализация для Single (числа с плавающей точкой)
 procedure R3D_ENVIRONMENT_SET(const Path: string; Value: Single);
 var
@@ -419,6 +1762,7 @@ begin
 end;
 
 
+finalization
+  R3D_ShutdownAsyncTextures;
 
 end.
-